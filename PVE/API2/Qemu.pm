@@ -532,6 +532,17 @@ __PACKAGE__->register_method({
 		    description => "Start the VM immediately from the backup and restore in background. PBS only.",
 		    requires => 'archive',
 		},
+		'restore-workers' => {
+		    optional => 1,
+		    type => 'integer',
+		    minimum => 1,
+		    maximum => 16,
+		    default => 4,
+		    description => "Number of disk images restored in parallel. Disks on a storage with"
+			." a configured restore bandwidth limit are restored one at a time, the limit"
+			." itself is not applied. PBS only.",
+		    requires => 'archive',
+		},
 		pool => {
 		    optional => 1,
 		    type => 'string', format => 'pve-poolid',
@@ -574,6 +585,7 @@ __PACKAGE__->register_method({
 	my $storage = extract_param($param, 'storage');
 	my $unique = extract_param($param, 'unique');
 	my $live_restore = extract_param($param, 'live-restore');
+	my $restore_workers = extract_param($param, 'restore-workers');
 
 	if (defined(my $ssh_keys = $param->{sshkeys})) {
 		$ssh_keys = URI::Escape::uri_unescape($ssh_keys);
@@ -661,6 +673,7 @@ __PACKAGE__->register_method({
 		    unique => $unique,
 		    bwlimit => $bwlimit,
 		    live => $live_restore,
+		    workers => $restore_workers,
 		};
 		if ($archive->{type} eq 'file' || $archive->{type} eq 'pipe') {
 		    die "live-restore is only compatible with backup images from a Proxmox Backup Server\n"
@@ -2241,6 +2254,12 @@ __PACKAGE__->register_method({
 		default => 'max(30, vm memory in GiB)',
 		optional => 1,
 	    },
+	    profile => {
+		description => "Print how long each phase of the start took.",
+		type => 'boolean',
+		default => 0,
+		optional => 1,
+	    },
 	},
     },
     returns => {
@@ -2255,6 +2274,7 @@ __PACKAGE__->register_method({
 	my $node = extract_param($param, 'node');
 	my $vmid = extract_param($param, 'vmid');
 	my $timeout = extract_param($param, 'timeout');
+	my $profile = extract_param($param, 'profile');
 
 	my $machine = extract_param($param, 'machine');
 	my $force_cpu = extract_param($param, 'force-cpu');
@@ -2343,6 +2363,7 @@ __PACKAGE__->register_method({
 		    forcemachine => $machine,
 		    timeout => $timeout,
 		    forcecpu => $force_cpu,
+		    profile => $profile,
 		};
 
 		PVE::QemuServer::vm_start($storecfg, $vmid, $params, $migrate_opts);
@@ -2993,6 +3014,15 @@ __PACKAGE__->register_method({
 		minimum => '0',
 		default => 'clone limit from datacenter or storage config',
 	    },
+	    'clone-workers' => {
+		description => "Number of drives copied in parallel when cloning a stopped VM or"
+		    ." a snapshot. A bandwidth limit is shared between them.",
+		optional => 1,
+		type => 'integer',
+		minimum => 1,
+		maximum => 16,
+		default => 4,
+	    },
         },
     },
     returns => {
@@ -3158,43 +3188,104 @@ __PACKAGE__->register_method({
 		    PVE::Storage::activate_volumes($storecfg, $vollist, $snapname);
 
 		    my $bwlimit = extract_param($param, 'bwlimit');
+		    my $workers = extract_param($param, 'clone-workers') // 4;
 
 		    my $total_jobs = scalar(keys %{$drives});
 		    my $i = 1;
 
-		    foreach my $opt (sort keys %$drives) {
-			my $drive = $drives->{$opt};
-			my $skipcomplete = ($total_jobs != $i); # finish after last drive
-			my $completion = $skipcomplete ? 'skip' : 'complete';
-
+		    my $get_clonelimit = sub {
+			my ($drive) = @_;
 			my $src_sid = PVE::Storage::parse_volume_id($drive->{file});
 			my $storage_list = [ $src_sid ];
 			push @$storage_list, $storage if defined($storage);
-			my $clonelimit = PVE::Storage::get_bandwidth_limit('clone', $storage_list, $bwlimit);
+			return PVE::Storage::get_bandwidth_limit('clone', $storage_list, $bwlimit);
+		    };
+
+		    my $clone_drive = sub {
+			my ($opt, $completion, $clonelimit, $vollist, $log_prefix) = @_;
 
-			my $newdrive = PVE::QemuServer::clone_disk(
+			return PVE::QemuServer::clone_disk(
 			    $storecfg,
 			    $vmid,
 			    $running,
 			    $opt,
-			    $drive,
+			    $drives->{$opt},
 			    $snapname,
 			    $newid,
 			    $storage,
 			    $format,
 			    $fullclone->{$opt},
-			    $newvollist,
+			    $vollist,
 			    $jobs,
 			    $completion,
 			    $oldconf->{agent},
 			    $clonelimit,
-			    $oldconf
+			    $oldconf,
+			    $log_prefix,
 			);
+		    };
 
-			$newconf->{$opt} = PVE::QemuServer::print_drive($newdrive);
+		    $workers = $total_jobs if $workers > $total_jobs;
+
+		    if ((!$running || $snapname) && $workers > 1) {
+			# offline copies do not depend on each other, so do them at once
+			print "cloning $total_jobs drives using $workers parallel workers\n";
+
+			my $clone_jobs = [];
+			foreach my $opt (sort keys %$drives) {
+			    my $clonelimit = $get_clonelimit->($drives->{$opt});
+			    # the limit is a budget for the whole clone, share it between the workers
+			    $clonelimit = int($clonelimit / $workers) || 1 if $clonelimit;
+
+			    push @$clone_jobs, {
+				name => $opt,
+				code => sub {
+				    my ($prefix) = @_;
+				    my $vollist = [];
+				    my $newdrive = eval {
+					$clone_drive->($opt, 'complete', $clonelimit, $vollist, $prefix);
+				    };
+				    if (my $err = $@) {
+					# the parent does not know about our volumes, clean them up here
+					for my $volid (@$vollist) {
+					    eval { PVE::Storage::vdisk_free($storecfg, $volid) };
+					    warn $@ if $@;
+					}
+					die $err;
+				    }
+				    return {
+					drive => PVE::QemuServer::print_drive($newdrive),
+					volids => $vollist,
+				    };
+				},
+			    };
+			}
+
+			eval { PVE::QemuServer::run_jobs_in_parallel($clone_jobs, $workers) };
+			my $err = $@;
+
+			for my $job (@$clone_jobs) {
+			    my $res = $job->{result} or next;
+			    push @$newvollist, @{$res->{volids}};
+			    $newconf->{$job->{name}} = $res->{drive};
+			}
+			die $err if $err;
 
 			PVE::QemuConfig->write_config($newid, $newconf);
-			$i++;
+		    } else {
+			foreach my $opt (sort keys %$drives) {
+			    my $skipcomplete = ($total_jobs != $i); # finish after last drive
+			    my $completion = $skipcomplete ? 'skip' : 'complete';
+
+			    my $clonelimit = $get_clonelimit->($drives->{$opt});
+
+			    my $newdrive = $clone_drive->($opt, $completion, $clonelimit, $newvollist);
+
+			    $newconf->{$opt} = PVE::QemuServer::print_drive($newdrive);
+
+			    PVE::QemuConfig->write_config($newid, $newconf);
+			    $i++;
+			}
 		    }
 
 		    delete $newconf->{lock};
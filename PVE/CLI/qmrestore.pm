@@ -64,6 +64,13 @@ __PACKAGE__->register_method({
 		type => 'boolean',
 		description => "Start the VM immediately from the backup and restore in background. PBS only.",
 	    },
+	    'restore-workers' => {
+		optional => 1,
+		type => 'integer',
+		minimum => 1,
+		maximum => 16,
+		description => "Number of disk images restored in parallel. PBS only.",
+	    },
 	},
     },
     returns => {
@@ -602,6 +602,16 @@ sub handle_replication {
 	    die "can't live migrate VM with replicated volumes, pve-qemu to old (< 4.2)!\n"
 	}
 
+	# a previous, aborted migration might have left its tracking bitmaps behind
+	my $existing_bitmaps = {};
+	my $blockinfo = mon_cmd($vmid, 'query-block');
+	for my $info (@$blockinfo) {
+	    my $device = $info->{device} or next;
+	    for my $bitmap (@{$info->{inserted}->{'dirty-bitmaps'} // []}) {
+		$existing_bitmaps->{$device}->{$bitmap->{name}} = 1 if defined($bitmap->{name});
+	    }
+	}
+
 	my @live_replicatable_volumes = $self->filter_local_volumes('online', 1);
 	foreach my $volid (@live_replicatable_volumes) {
 	    my $drive = $local_volumes->{$volid}->{drivename};
@@ -609,6 +619,11 @@ sub handle_replication {
 
 	    my $bitmap = "repl_$drive";
 
+	    if ($existing_bitmaps->{"drive-$drive"}->{$bitmap}) {
+		$self->log('info', "$drive: removing left-over block-dirty-bitmap '$bitmap'");
+		mon_cmd($vmid, 'block-dirty-bitmap-remove', node => "drive-$drive", name => $bitmap);
+	    }
+
 	    # start tracking before replication to get full delta + a few duplicates
 	    $self->log('info', "$drive: start tracking writes using block-dirty-bitmap '$bitmap'");
 	    mon_cmd($vmid, 'block-dirty-bitmap-add', node => "drive-$drive", name => $bitmap);
@@ -1184,6 +1184,32 @@ sub kvm_version {
 my $kvm_user_version = {};
 my $kvm_mtime = {};
 
+# every worker is a new process, so also keep the version in a file shared by all of them, keyed
+# by the binary's mtime and size, to avoid executing QEMU just to learn its version
+my $kvm_version_cache_fn = sub {
+    my ($binary) = @_;
+    return "$PVE::QemuServer::Helpers::var_run_tmpdir/" . basename($binary) . ".version";
+};
+
+my $read_kvm_version_cache = sub {
+    my ($binary, $st) = @_;
+
+    my $raw = eval { file_get_contents($kvm_version_cache_fn->($binary)) } // return;
+    my $cache = eval { decode_json($raw) } // return;
+
+    return if ($cache->{binary} // '') ne $binary;
+    return if ($cache->{mtime} // -1) != $st->mtime || ($cache->{size} // -1) != $st->size;
+    return $cache->{version};
+};
+
+my $write_kvm_version_cache = sub {
+    my ($binary, $st, $version) = @_;
+
+    my $cache = { binary => $binary, mtime => $st->mtime, size => $st->size, version => $version };
+    eval { PVE::Tools::file_set_contents($kvm_version_cache_fn->($binary), encode_json($cache)) };
+    # not fatal, we just have to ask QEMU again next time
+};
+
 sub kvm_user_version {
     my ($binary) = @_;
 
@@ -1194,9 +1220,14 @@ sub kvm_user_version {
     return $kvm_user_version->{$binary} if $kvm_user_version->{$binary} &&
 	$cachedmtime == $st->mtime;
 
-    $kvm_user_version->{$binary} = 'unknown';
     $kvm_mtime->{$binary} = $st->mtime;
 
+    if (my $version = $read_kvm_version_cache->($binary, $st)) {
+	return $kvm_user_version->{$binary} = $version;
+    }
+
+    $kvm_user_version->{$binary} = 'unknown';
+
     my $code = sub {
 	my $line = shift;
 	if ($line =~ m/^QEMU( PC)? emulator version (\d+\.\d+(\.\d+)?)(\.\d+)?[,\s]/) {
@@ -1207,6 +1238,9 @@ sub kvm_user_version {
     eval { run_command([$binary, '--version'], outfunc => $code); };
     warn $@ if $@;
 
+    $write_kvm_version_cache->($binary, $st, $kvm_user_version->{$binary})
+	if $kvm_user_version->{$binary} ne 'unknown';
+
     return $kvm_user_version->{$binary};
 
 }
@@ -5132,6 +5166,7 @@ sub vm_start {
 #   forcecpu => a QEMU '-cpu' argument string to override get_cpu_options
 #   timeout => in seconds
 #   paused => start VM in paused state (backup)
+#   profile => print how long each phase of the start took
 #   resume => resume from hibernation
 #   pbs-backing => {
 #      sata0 => {
@@ -5161,6 +5196,16 @@ sub vm_start_nolock {
 
     my $res = {};
 
+    my $starttime = [gettimeofday];
+    my $phase_start = $starttime;
+    my $phases = [];
+    my $phase_done = sub {
+	my ($name) = @_;
+	my $now = [gettimeofday];
+	push @$phases, [$name, Time::HiRes::tv_interval($phase_start, $now)];
+	$phase_start = $now;
+    };
+
     # clean up leftover reboot request files
     eval { clear_reboot_request($vmid); };
     warn $@ if $@;
@@ -5171,6 +5216,7 @@ sub vm_start_nolock {
     }
 
     PVE::QemuServer::Cloudinit::generate_cloudinitconfig($conf, $vmid);
+    $phase_done->('config');
 
     my $defaults = load_defaults();
 
@@ -5178,6 +5224,7 @@ sub vm_start_nolock {
     $ENV{PVE_MIGRATED_FROM} = $migratedfrom if $migratedfrom;
 
     PVE::GuestHelpers::exec_hookscript($conf, $vmid, 'pre-start', 1);
+    $phase_done->('pre-start hook');
 
     my $forcemachine = $params->{forcemachine};
     my $forcecpu = $params->{forcecpu};
@@ -5190,6 +5237,7 @@ sub vm_start_nolock {
 
     my ($cmd, $vollist, $spice_port) = config_to_command($storecfg, $vmid,
 	$conf, $defaults, $forcemachine, $forcecpu, $params->{'pbs-backing'});
+    $phase_done->('command line');
 
     my $migration_ip;
     my $get_migration_ip = sub {
@@ -5294,8 +5342,10 @@ sub vm_start_nolock {
 	    }
       }
     }
+    $phase_done->('pci devices');
 
     PVE::Storage::activate_volumes($storecfg, $vollist);
+    $phase_done->('volume activation');
 
     eval {
 	run_command(['/bin/systemctl', 'stop', "$vmid.scope"],
@@ -5304,6 +5354,7 @@ sub vm_start_nolock {
     # Issues with the above 'stop' not being fully completed are extremely rare, a very low
     # timeout should be more than enough here...
     PVE::Systemd::wait_for_unit_removed("$vmid.scope", 5);
+    $phase_done->('scope cleanup');
 
     my $cpuunits = get_cpuunits($conf);
 
@@ -5379,6 +5430,7 @@ sub vm_start_nolock {
 	eval { PVE::Storage::deactivate_volumes($storecfg, $vollist); };
 	die "start failed: $err";
     }
+    $phase_done->('qemu launch');
 
     print "migration listens on $migrate_uri\n" if $migrate_uri;
     $res->{migrate_uri} = $migrate_uri;
@@ -5472,8 +5524,20 @@ sub vm_start_nolock {
 	delete $conf->@{qw(lock vmstate runningmachine runningcpu)};
 	PVE::QemuConfig->write_config($vmid, $conf);
     }
+    $phase_done->('monitor setup');
 
     PVE::GuestHelpers::exec_hookscript($conf, $vmid, 'post-start');
+    $phase_done->('post-start hook');
+
+    my $total = Time::HiRes::tv_interval($starttime);
+    if ($params->{profile}) {
+	print "start phase timings:\n";
+	printf("  %-20s %8.3f s\n", $_->[0], $_->[1]) for @$phases;
+	printf("  %-20s %8.3f s\n", 'total', $total);
+    } elsif (!$migratedfrom) { # the source node logs all our output, keep that short
+	my $summary = join(', ', map { sprintf("%s %.2fs", @$_) } @$phases);
+	printf("VM $vmid started in %.2f seconds ($summary)\n", $total);
+    }
 
     return $res;
 }
@@ -6004,6 +6068,149 @@ my $parse_backup_hints = sub {
     return $virtdev_hash;
 };
 
+# Whether restoring to the freshly allocated $volid may skip writing zero blocks. That is only
+# safe if the volume reads back as zeros. Skipping is not wanted if preallocation was asked for,
+# which only the tar archive restore supports.
+sub restore_skip_zeros {
+    my ($storecfg, $volid, $prealloc) = @_;
+
+    return 0 if $prealloc;
+    return PVE::Storage::volume_has_feature($storecfg, 'sparseinit', $volid) ? 1 : 0;
+}
+
+# Runs the code of each job in a forked worker, with at most $max_workers running at once. Jobs
+# with the same 'group' are additionally limited to $group_limits->{$group} concurrent workers,
+# if set. The job's code gets "$name: " passed as prefix, which it should put in front of any
+# output, so that the lines of concurrent jobs can be told apart. Only error messages are prefixed
+# here. A defined return value of the job's code is passed back to the parent and stored as the
+# job's 'result'. On the first failure the remaining workers get terminated and no further jobs are
+# started. Only the workers started here are waited for, other children of the caller are left be.
+sub run_jobs_in_parallel {
+    my ($jobs, $max_workers, $group_limits) = @_;
+
+    $max_workers = 1 if !$max_workers || $max_workers < 1;
+    $group_limits //= {};
+
+    my @queue = @$jobs;
+    my $running = {}; # pid => job
+    my $group_count = {};
+    my $errors = [];
+
+    my $can_start = sub {
+	my ($job) = @_;
+	my $group = $job->{group};
+	return 1 if !defined($group) || !defined($group_limits->{$group});
+	return ($group_count->{$group} // 0) < $group_limits->{$group};
+    };
+
+    # returns false once the writer closed the pipe
+    my $read_result = sub {
+	my ($job) = @_;
+	my $n = sysread($job->{result_fh}, my $buf, 65536);
+	return 1 if !defined($n) && $! == POSIX::EINTR;
+	return 0 if !$n;
+	$job->{result_raw} .= $buf;
+	return 1;
+    };
+
+    my $reap = sub {
+	my ($pid, $exitcode);
+	while (!defined($pid)) {
+	    for my $cpid (keys %$running) {
+		my $res = waitpid($cpid, POSIX::WNOHANG);
+		if ($res == $cpid) {
+		    ($pid, $exitcode) = ($cpid, $?);
+		    last;
+		} elsif ($res < 0) { # should not happen, but never wait forever
+		    ($pid, $exitcode) = ($cpid, -1);
+		    last;
+		}
+	    }
+	    last if defined($pid);
+
+	    # keep draining the result pipes, a worker with a result larger than the pipe buffer
+	    # would otherwise never exit
+	    my $by_fh = { map { $_->{result_fh} => $_ } grep { $_->{result_fh} } values %$running };
+	    my @fhs = map { $_->{result_fh} } values %$by_fh;
+	    if (!scalar(@fhs)) {
+		select(undef, undef, undef, 0.1);
+		next;
+	    }
+	    for my $fh (IO::Select->new(@fhs)->can_read(0.1)) {
+		my $job = $by_fh->{$fh};
+		next if $read_result->($job);
+		close(delete $job->{result_fh});
+	    }
+	}
+	my $job = delete $running->{$pid};
+	$group_count->{$job->{group}}-- if defined($job->{group});
+
+	if ($job->{result_fh}) {
+	    1 while $read_result->($job);
+	    close(delete $job->{result_fh});
+	}
+	my $raw = delete $job->{result_raw} // '';
+	$job->{result} = eval { decode_json($raw)->[0] } if length($raw) && !$exitcode;
+
+	if ($exitcode < 0) {
+	    push @$errors, "$job->{name}: worker vanished\n";
+	} elsif (my $sig = $exitcode & 127) {
+	    push @$errors, "$job->{name}: worker terminated by signal $sig\n";
+	} elsif ($exitcode) {
+	    push @$errors, "$job->{name}: worker failed with exit code " . ($exitcode >> 8) . "\n";
+	}
+    };
+
+    eval {
+	while (scalar(@queue) || scalar(%$running)) {
+	    if (!scalar(@$errors) && scalar(keys %$running) < $max_workers) {
+		my ($idx) = grep { $can_start->($queue[$_]) } 0 .. $#queue;
+		if (defined($idx)) {
+		    my $job = splice(@queue, $idx, 1);
+
+		    pipe(my $reader, my $writer) or die "unable to create pipe - $!\n";
+
+		    my $pid = fork();
+		    die "unable to fork worker for '$job->{name}' - $!\n" if !defined($pid);
+
+		    if ($pid == 0) {
+			close($reader);
+			STDOUT->autoflush(1); # we leave via _exit, which does not flush
+			my $prefix = "$job->{name}: ";
+			my $res = eval { $job->{code}->($prefix) };
+			if (my $err = $@) {
+			    print STDERR "$prefix$err";
+			    POSIX::_exit(1);
+			}
+			print $writer encode_json([$res]) if defined($res);
+			close($writer);
+			POSIX::_exit(0);
+		    }
+
+		    close($writer);
+		    $job->{result_fh} = $reader;
+		    $running->{$pid} = $job;
+		    $group_count->{$job->{group}}++ if defined($job->{group});
+		    next;
+		}
+	    }
+	    last if !scalar(%$running);
+	    $reap->();
+	    last if scalar(@$errors); # the remaining workers get terminated below
+	}
+    };
+    if (my $err = $@) {
+	push @$errors, $err;
+    }
+
+    if (scalar(%$running)) {
+	kill('TERM', keys %$running);
+	$reap->() while scalar(%$running);
+    }
+
+    die join('', @$errors) if scalar(@$errors);
+}
+
 # Helper to allocate and activate all volumes required for a restore
 #
 # $storecfg: Storage configuration
@@ -6014,6 +6221,8 @@ my $restore_allocate_devices = sub {
     my ($storecfg, $virtdev_hash, $vmid) = @_;
 
     my $map = {};
+    my $jobs = [];
+    my $storages = {};
     foreach my $virtdev (sort keys %$virtdev_hash) {
 	my $d = $virtdev_hash->{$virtdev};
 	my $alloc_size = int(($d->{size} + 1024 - 1)/1024);
@@ -6034,15 +6243,61 @@ my $restore_allocate_devices = sub {
 	    }
 	}
 
-	my $volid = PVE::Storage::vdisk_alloc(
-	    $storecfg, $storeid, $vmid, $d->{format}, $name, $alloc_size);
+	my $alloc = sub {
+	    my $volid = PVE::Storage::vdisk_alloc(
+		$storecfg, $storeid, $vmid, $d->{format}, $name, $alloc_size);
+
+	    print STDERR "new volume ID is '$volid'\n";
+	    $d->{volid} = $volid;
 
-	print STDERR "new volume ID is '$volid'\n";
-	$d->{volid} = $volid;
+	    PVE::Storage::activate_volumes($storecfg, [$volid]);
+
+	    return $volid;
+	};
 
-	PVE::Storage::activate_volumes($storecfg, [$volid]);
+	# when run in a worker, the parent only learns about the volume if we succeed
+	my $alloc_in_worker = sub {
+	    local $SIG{TERM} = sub { die "interrupted by signal\n"; };
+	    my $volid = eval { $alloc->() };
+	    if (my $err = $@) {
+		if (my $volid = $d->{volid}) {
+		    eval { PVE::Storage::vdisk_free($storecfg, $volid) };
+		    warn $@ if $@;
+		}
+		die $err;
+	    }
+	    return $volid;
+	};
 
-	$map->{$virtdev} = $volid;
+	push @$jobs, {
+	    name => $virtdev,
+	    group => $storeid,
+	    virtdev => $virtdev,
+	    alloc => $alloc,
+	    code => $alloc_in_worker,
+	};
+	$storages->{$storeid} = 1;
+    }
+
+    if (scalar(keys %$storages) > 1) {
+	# allocation can take a while on some storages (e.g. with full preallocation), so work on
+	# all involved storages at once, but keep it to one volume at a time for each of them
+	my $group_limits = { map { $_ => 1 } keys %$storages };
+	eval { run_jobs_in_parallel($jobs, scalar(keys %$storages), $group_limits) };
+	my $err = $@;
+
+	# remember what got allocated, even on error, so that it gets cleaned up. Workers that failed
+	# or got terminated freed their volume already.
+	for my $job (@$jobs) {
+	    next if !defined(my $volid = $job->{result});
+	    $virtdev_hash->{$job->{virtdev}}->{volid} = $volid;
+	    $map->{$job->{virtdev}} = $volid;
+	}
+	die $err if $err;
+    } else {
+	for my $job (@$jobs) {
+	    $map->{$job->{virtdev}} = $job->{alloc}->(); # sets volid itself, for cleanup on error
+	}
     }
 
     return $map;
@@ -6392,6 +6647,8 @@ sub restore_proxmox_backup_archive {
 	# allocate volumes
 	my $map = $restore_allocate_devices->($storecfg, $virtdev_hash, $vmid);
 
+	my $restore_jobs = [];
+	my $storage_limits = {};
 	foreach my $virtdev (sort keys %$virtdev_hash) {
 	    my $d = $virtdev_hash->{$virtdev};
 	    next if $d->{is_cloudinit}; # no need to restore cloudinit
@@ -6415,13 +6672,40 @@ sub restore_proxmox_backup_archive {
 	    push @$pbs_restore_cmd, '--format', $d->{format} if $d->{format};
 	    push @$pbs_restore_cmd, '--keyfile', $keyfile if -e $keyfile;
 
-	    if (PVE::Storage::volume_has_feature($storecfg, 'sparseinit', $volid)) {
+	    if (restore_skip_zeros($storecfg, $volid)) {
 		push @$pbs_restore_cmd, '--skip-zero';
 	    }
 
 	    my $dbg_cmdstring = PVE::Tools::cmd2string($pbs_restore_cmd);
 	    print "restore proxmox backup image: $dbg_cmdstring\n";
-	    run_command($pbs_restore_cmd);
+
+	    # pbs-restore cannot be rate limited (see above), so a configured restore limit is not
+	    # enforced. Only restore one disk at a time to such storages, to not add to their load.
+	    my $storeid = $d->{storeid};
+	    $storage_limits->{$storeid} = 1
+		if PVE::Storage::get_bandwidth_limit('restore', [$storeid], $options->{bwlimit});
+
+	    push @$restore_jobs, {
+		name => $d->{devname},
+		group => $storeid,
+		code => sub {
+		    my ($prefix) = @_;
+		    run_command(
+			$pbs_restore_cmd,
+			outfunc => sub { print "$prefix$_[0]\n"; },
+			errfunc => sub { print STDERR "$prefix$_[0]\n"; },
+		    );
+		},
+	    };
+	}
+
+	if (scalar(@$restore_jobs) > 1) {
+	    my $workers = $options->{workers} // 4;
+	    $workers = scalar(@$restore_jobs) if $workers > scalar(@$restore_jobs);
+	    print "restoring " . scalar(@$restore_jobs) . " images using $workers parallel workers\n";
+	    run_jobs_in_parallel($restore_jobs, $workers, $storage_limits);
+	} elsif (my $job = $restore_jobs->[0]) {
+	    $job->{code}->('');
 	}
 
 	$fh->seek(0, 0) || die "seek failed - $!\n";
@@ -6477,19 +6761,21 @@ sub restore_proxmox_backup_archive {
 	die "cannot do live-restore for template\n" if PVE::QemuConfig->is_template($conf);
 
 	delete $devinfo->{'drive-efidisk0'}; # this special drive is already restored before start
-	pbs_live_restore($vmid, $conf, $storecfg, $devinfo, $repo, $keyfile, $pbs_backup_name);
+	pbs_live_restore(
+	    $vmid, $conf, $storecfg, $devinfo, $repo, $keyfile, $pbs_backup_name, $options->{bwlimit});
 
 	PVE::QemuConfig->remove_lock($vmid, "create");
     }
 }
 
 sub pbs_live_restore {
-    my ($vmid, $conf, $storecfg, $restored_disks, $repo, $keyfile, $snap) = @_;
+    my ($vmid, $conf, $storecfg, $restored_disks, $repo, $keyfile, $snap, $bwlimit) = @_;
 
     print "starting VM for live-restore\n";
     print "repository: '$repo', snapshot: '$snap'\n";
 
     my $pbs_backing = {};
+    my $stream_speed = {};
     for my $ds (keys %$restored_disks) {
 	$ds =~ m/^drive-(.*)$/;
 	my $confname = $1;
@@ -6502,6 +6788,15 @@ sub pbs_live_restore {
 
 	my $drive = parse_drive($confname, $conf->{$confname});
 	print "restoring '$ds' to '$drive->{file}'\n";
+
+	# the guest fetches data it needs on demand, throttling the background copy leaves more
+	# bandwidth of the backup server and target storage to those reads
+	my ($storeid) = PVE::Storage::parse_volume_id($drive->{file});
+	my $limit = PVE::Storage::get_bandwidth_limit('restore', [$storeid], $bwlimit);
+	if ($limit) {
+	    print "limiting background restore of '$ds' to $limit KiB/s\n";
+	    $stream_speed->{$ds} = $limit * 1024;
+	}
     }
 
     my $drives_streamed = 0;
@@ -6527,6 +6822,7 @@ sub pbs_live_restore {
 	    mon_cmd($vmid, 'block-stream',
 		'job-id' => $job_id,
 		device => "$ds",
+		$stream_speed->{$ds} ? (speed => int($stream_speed->{$ds})) : (),
 	    );
 	    $jobs->{$job_id} = {};
 	}
@@ -6553,6 +6849,21 @@ sub pbs_live_restore {
     }
 }
 
+# pigz decompresses considerably faster than gzip, as reading, writing and checksumming run in
+# separate threads, use it if installed
+my $restore_decompressor_cmd = sub {
+    my ($format, $comp) = @_;
+
+    my $info = PVE::Storage::decompressor_info($format, $comp);
+    my $cmd = $info->{decompressor};
+
+    if ($format eq 'vma' && $comp eq 'gz' && $cmd->[0] eq 'zcat' && -x '/usr/bin/pigz') {
+	$cmd = ['pigz', '-d', '-c'];
+    }
+
+    return $cmd;
+};
+
 sub restore_vma_archive {
     my ($archive, $vmid, $user, $opts, $comp) = @_;
 
@@ -6590,8 +6901,7 @@ sub restore_vma_archive {
     }
 
     if ($comp) {
-	my $info = PVE::Storage::decompressor_info('vma', $comp);
-	my $cmd = $info->{decompressor};
+	my $cmd = $restore_decompressor_cmd->('vma', $comp);
 	push @$cmd, $readfrom;
 	$add_pipe->($cmd);
     }
@@ -6680,10 +6990,7 @@ sub restore_vma_archive {
 		$map_opts .= "throttling.bps=$limit:throttling.group=$storeid:";
 	    }
 
-	    my $write_zeros = 1;
-	    if (PVE::Storage::volume_has_feature($cfg, 'sparseinit', $volid)) {
-		$write_zeros = 0;
-	    }
+	    my $write_zeros = restore_skip_zeros($cfg, $volid) ? 0 : 1;
 
 	    my $path = PVE::Storage::path($cfg, $volid);
 
@@ -6798,6 +7105,12 @@ sub restore_tar_archive {
     my $cmd = "zcat -f|tar xf " . PVE::Tools::shellquote($archive) . " " .
 	PVE::Tools::shellquote("--to-command=$tocmd");
 
+    if ($archive ne '-' && $archive =~ m/\.(?:tgz|tar\.gz)$/ && -x '/usr/bin/pigz') {
+	# tar decompresses gzip single-threaded, let pigz read the archive and feed tar instead
+	$cmd = "pigz -d -c " . PVE::Tools::shellquote($archive) . "|tar xf - " .
+	    PVE::Tools::shellquote("--to-command=$tocmd");
+    }
+
     my $tmpdir = "/var/tmp/vzdumptmp$$";
     mkpath $tmpdir;
 
@@ -6968,7 +7281,9 @@ sub convert_iscsi_path {
 }
 
 sub qemu_img_convert {
-    my ($src_volid, $dst_volid, $size, $snapname, $is_zero_initialized) = @_;
+    my ($src_volid, $dst_volid, $size, $snapname, $is_zero_initialized, $bwlimit, $log_prefix) = @_;
+
+    $log_prefix //= '';
 
     my $storecfg = PVE::Storage::config();
     my ($src_storeid, $src_volname) = PVE::Storage::parse_volume_id($src_volid, 1);
@@ -7008,6 +7323,10 @@ sub qemu_img_convert {
 	if $snapname && $src_format && $src_format eq "qcow2";
     push @$cmd, '-t', 'none' if $dst_scfg->{type} eq 'zfspool';
     push @$cmd, '-T', $cachemode if defined($cachemode);
+    push @$cmd, '-r', "${bwlimit}K" if $bwlimit; # in KiB/s
+    # allow out-of-order writes for raw volumes on block or network storages, this does not lead
+    # to fragmentation there and helps a lot with the latency of e.g. RBD or iSCSI
+    push @$cmd, '-W' if $dst_format eq 'raw' && !$dst_scfg->{path};
 
     if ($src_is_iscsi) {
 	push @$cmd, '--image-opts';
@@ -7039,7 +7358,7 @@ sub qemu_img_convert {
 	    my $total_h = render_bytes($size, 1);
 	    my $transferred_h = render_bytes($transferred, 1);
 
-	    print "transferred $transferred_h of $total_h ($percent%)\n";
+	    print "${log_prefix}transferred $transferred_h of $total_h ($percent%)\n";
 	}
 
     };
@@ -7280,9 +7599,49 @@ sub qemu_blockjobs_cancel {
     }
 }
 
+# Try to copy a raw, file based volume by reflink, which is instant on file systems with
+# copy-on-write support (e.g. btrfs and XFS). Returns false if that is not possible, caller needs
+# to copy then. Other formats are not reflinked, a qcow2 file for example also contains the
+# internal snapshots of the source, which must not end up in the clone.
+my $reflink_clone_volume = sub {
+    my ($storecfg, $src_volid, $dst_volid) = @_;
+
+    my ($src_storeid) = PVE::Storage::parse_volume_id($src_volid, 1);
+    return 0 if !$src_storeid;
+    return 0 if !PVE::Storage::storage_config($storecfg, $src_storeid)->{path};
+
+    my (undef, undef, undef, $basename, undef, undef, $src_format) =
+	PVE::Storage::parse_volname($storecfg, $src_volid);
+    my (undef, undef, undef, undef, undef, undef, $dst_format) =
+	PVE::Storage::parse_volname($storecfg, $dst_volid);
+    # images of linked clones reference their base, we want an independent copy
+    return 0 if $basename;
+    return 0 if ($src_format // '') ne 'raw' || ($dst_format // '') ne 'raw';
+
+    my $src_path = PVE::Storage::path($storecfg, $src_volid);
+    my $dst_path = PVE::Storage::path($storecfg, $dst_volid);
+    return 0 if ! -f $src_path || ! -f $dst_path;
+
+    # cp truncates the target before trying, so do not use the allocated image directly
+    my $tmp_path = "$dst_path.tmp.$$";
+    eval {
+	run_command(['cp', '--reflink=always', '--', $src_path, $tmp_path], errfunc => sub {});
+	rename($tmp_path, $dst_path) or die "rename failed - $!\n";
+    };
+    if ($@) {
+	unlink $tmp_path;
+	print "copy-on-write clone of '$src_volid' not possible, doing a full copy\n";
+	return 0;
+    }
+
+    print "created copy-on-write clone of '$src_volid'\n";
+    return 1;
+};
+
 sub clone_disk {
     my ($storecfg, $vmid, $running, $drivename, $drive, $snapname,
-	$newvmid, $storage, $format, $full, $newvollist, $jobs, $completion, $qga, $bwlimit, $conf) = @_;
+	$newvmid, $storage, $format, $full, $newvollist, $jobs, $completion, $qga, $bwlimit, $conf,
+	$log_prefix) = @_;
 
     my $newvolid;
 
@@ -7332,7 +7691,8 @@ sub clone_disk {
 
 	my $sparseinit = PVE::Storage::volume_has_feature($storecfg, 'sparseinit', $newvolid);
 	if (!$running || $snapname) {
-	    # TODO: handle bwlimits
+	    my $starttime = [gettimeofday];
+
 	    if ($drivename eq 'efidisk0') {
 		# the relevant data on the efidisk may be smaller than the source
 		# e.g. on RBD/ZFS, so we use dd to copy only the amount
@@ -7346,8 +7706,15 @@ sub clone_disk {
 		run_command(['qemu-img', 'dd', '-n', '-O', $dst_format, "bs=$bs", "osize=$size",
 		    "if=$src_path", "of=$dst_path"]);
 	    } else {
-		qemu_img_convert($drive->{file}, $newvolid, $size, $snapname, $sparseinit);
+		my $reflinked = !$snapname
+		    && $reflink_clone_volume->($storecfg, $drive->{file}, $newvolid);
+		qemu_img_convert(
+		    $drive->{file}, $newvolid, $size, $snapname, $sparseinit, $bwlimit, $log_prefix)
+		    if !$reflinked;
 	    }
+
+	    my $duration = Time::HiRes::tv_interval($starttime);
+	    print "drive $drivename cloned in " . sprintf("%.2f", $duration) . " seconds\n";
 	} else {
 
 	    my $kvmver = get_running_qemu_version ($vmid);
@@ -3,12 +3,14 @@ package PVE::VZDump::QemuServer;
 use strict;
 use warnings;
 
+use Fcntl qw(F_SETPIPE_SZ);
 use File::Basename;
 use File::Path;
 use IO::File;
 use IPC::Open3;
 use JSON;
 use POSIX qw(EINTR EAGAIN);
+use Time::HiRes qw(gettimeofday tv_interval);
 
 use PVE::Cluster qw(cfs_read_file);
 use PVE::INotify;
@@ -62,12 +64,14 @@ sub prepare {
     $self->loginfo("VM Name: $conf->{name}")
 	if defined($conf->{name});
 
-    $self->{vm_was_running} = 1;
-    $self->{vm_was_paused} = 0;
+    # keep per-guest state in $task and not in $self, the plugin instance is shared by all guests
+    # of a job and must not mix up their state if those get backed up concurrently
+    $task->{vm_was_running} = 1;
+    $task->{vm_was_paused} = 0;
     if (!PVE::QemuServer::check_running($vmid)) {
-	$self->{vm_was_running} = 0;
+	$task->{vm_was_running} = 0;
     } elsif (PVE::QemuServer::vm_is_paused($vmid)) {
-	$self->{vm_was_paused} = 1;
+	$task->{vm_was_paused} = 1;
     }
 
     $task->{hostname} = $conf->{name};
@@ -86,7 +90,7 @@ sub prepare {
 	if (!$volume->{included}) {
 	    $self->loginfo("exclude disk '$name' '$volid' ($volume->{reason})");
 	    next;
-	} elsif ($self->{vm_was_running} && $volume_config->{iothread}) {
+	} elsif ($task->{vm_was_running} && $volume_config->{iothread}) {
 	    if (!PVE::QemuServer::Machine::runs_at_least_qemu_version($vmid, 4, 0, 1)) {
 		die "disk '$name' '$volid' (iothread=on) can't use backup feature with running QEMU " .
 		    "version < 4.0.1! Either set backup=no for this drive or upgrade QEMU and restart VM\n";
@@ -180,7 +184,7 @@ sub start_vm {
 sub suspend_vm {
     my ($self, $task, $vmid) = @_;
 
-    return if $self->{vm_was_paused};
+    return if $task->{vm_was_paused};
 
     $self->cmd ("qm suspend $vmid --skiplock");
 }
@@ -188,7 +192,7 @@ sub suspend_vm {
 sub resume_vm {
     my ($self, $task, $vmid) = @_;
 
-    return if $self->{vm_was_paused};
+    return if $task->{vm_was_paused};
 
     $self->cmd ("qm resume $vmid --skiplock");
 }
@@ -292,7 +296,8 @@ my $bitmap_action_to_human = sub {
 my $query_backup_status_loop = sub {
     my ($self, $vmid, $job_uuid, $qemu_support) = @_;
 
-    my $starttime = time ();
+    # use sub-second precision, rounding to whole seconds made the rates jump around a lot
+    my $starttime = [gettimeofday];
     my $last_time = $starttime;
     my ($last_percent, $last_total, $last_target, $last_zero, $last_transferred) = (-1, 0, 0, 0, 0);
     my ($transferred, $reused);
@@ -343,8 +348,8 @@ my $query_backup_status_loop = sub {
 
 	die "got unexpected uuid\n" if !$status->{uuid} || ($status->{uuid} ne $job_uuid);
 
-	my $ctime = time();
-	my $duration = $ctime - $starttime;
+	my $ctime = [gettimeofday];
+	my $duration = tv_interval($starttime, $ctime);
 
 	my $rbytes = $transferred - $last_transferred;
 	my $wbytes;
@@ -355,7 +360,7 @@ my $query_backup_status_loop = sub {
 	    $wbytes = $rbytes - ($zero - $last_zero);
 	}
 
-	my $timediff = ($ctime - $last_time) || 1; # fixme
+	my $timediff = tv_interval($last_time, $ctime) || 0.001;
 	my $mbps_read = $get_mbps->($rbytes, $timediff);
 	my $mbps_write = $get_mbps->($wbytes, $timediff);
 	my $target_h = render_bytes($target, 1);
@@ -397,7 +402,7 @@ my $query_backup_status_loop = sub {
 	sleep(1);
     }
 
-    my $duration = time() - $starttime;
+    my $duration = tv_interval($starttime);
 
     if ($last_zero) {
 	my $zero_per = $last_target ? int(($last_zero * 100)/$last_target) : 0;
@@ -411,11 +416,11 @@ my $query_backup_status_loop = sub {
     }
     if ($transferred) {
 	my $transferred_h = render_bytes($transferred);
-	if ($duration) {
+	if ($duration >= 0.01) {
 	    my $mbps = $get_mbps->($transferred, $duration);
-	    $self->loginfo("transferred $transferred_h in $duration seconds ($mbps)");
+	    $self->loginfo(sprintf("transferred $transferred_h in %.2f seconds ($mbps)", $duration));
 	} else {
-	    $self->loginfo("transferred $transferred_h in <1 seconds");
+	    $self->loginfo("transferred $transferred_h in <0.01 seconds");
 	}
     }
 
@@ -474,8 +479,8 @@ sub archive_pbs {
     # get list early so we die on unkown drive types before doing anything
     my $devlist = _get_task_devlist($task);
 
-    $self->enforce_vm_running_for_backup($vmid);
-    $self->{qmeventd_fh} = PVE::QemuServer::register_qmeventd_handle($vmid);
+    $self->enforce_vm_running_for_backup($task, $vmid);
+    $task->{qmeventd_fh} = PVE::QemuServer::register_qmeventd_handle($vmid);
 
     my $backup_job_uuid;
     eval {
@@ -501,8 +506,6 @@ sub archive_pbs {
 	    $master_keyfile = undef; # skip rest of master key handling below
 	}
 
-	my $fs_frozen = $self->qga_fs_freeze($task, $vmid);
-
 	my $params = {
 	    format => "pbs",
 	    'backup-file' => $repo,
@@ -535,12 +538,15 @@ sub archive_pbs {
 
 	$params->{timeout} = 125; # give some time to connect to the backup server
 
+	# everything is prepared, keep the time the guest's file systems stay frozen minimal
+	my $fs_frozen = $self->qga_fs_freeze($task, $vmid);
+
 	my $res = eval { mon_cmd($vmid, "backup", %$params) };
 	my $qmperr = $@;
 	$backup_job_uuid = $res->{UUID} if $res;
 
 	if ($fs_frozen) {
-	    $self->qga_fs_thaw($vmid);
+	    $self->qga_fs_thaw($task, $vmid);
 	}
 
 	die $qmperr if $qmperr;
@@ -559,11 +565,26 @@ sub archive_pbs {
 	$self->mon_backup_cancel($vmid);
 	$self->resume_vm_after_job_start($task, $vmid);
     }
-    $self->restore_vm_power_state($vmid);
+    $self->restore_vm_power_state($task, $vmid);
 
     die $err if $err;
 }
 
+# use the biggest pipe buffer an unprivileged process may request, so that QEMU can hand over
+# whole backup extents at once instead of waking up the reader for every 64 KiB
+my $enlarge_pipe = sub {
+    my ($self, $fh) = @_;
+
+    my $max = PVE::Tools::file_read_firstline('/proc/sys/fs/pipe-max-size');
+    return if !defined($max) || $max !~ m/^(\d+)$/;
+    my $size = int($1);
+
+    # the size is a property of the pipe itself, so either end can be used
+    if (!fcntl($fh, F_SETPIPE_SZ, $size)) {
+	$self->loginfo("unable to set pipe size to $size bytes - $!");
+    }
+};
+
 my $fork_compressor_pipe = sub {
     my ($self, $comp, $outfileno) = @_;
 
@@ -580,6 +601,8 @@ my $fork_compressor_pipe = sub {
 	    die "unable to redirect STDIN - $!"
 		if !open(STDIN, "<&", $pipefd[0]);
 
+	    $enlarge_pipe->($self, \*STDIN);
+
 	    # redirect STDOUT
 	    $fd = fileno(STDOUT);
 	    close STDOUT;
@@ -662,8 +685,8 @@ sub archive_vma {
 
     my $devlist = _get_task_devlist($task);
 
-    $self->enforce_vm_running_for_backup($vmid);
-    $self->{qmeventd_fh} = PVE::QemuServer::register_qmeventd_handle($vmid);
+    $self->enforce_vm_running_for_backup($task, $vmid);
+    $task->{qmeventd_fh} = PVE::QemuServer::register_qmeventd_handle($vmid);
 
     my $cpid;
     my $backup_job_uuid;
@@ -682,6 +705,10 @@ sub archive_vma {
 	}
 	my $outfileno = fileno($outfh);
 
+	# QEMU writes directly to the output if we do not compress, a pipe given to us via
+	# '--stdout' then benefits from a bigger buffer just like the compressor pipe
+	$enlarge_pipe->($self, $outfh) if !$comp && -p $outfh;
+
 	if ($comp) {
 	    ($cpid, $outfileno) = $fork_compressor_pipe->($self, $comp, $outfileno);
 	}
@@ -705,6 +732,7 @@ sub archive_vma {
 	    $qmpclient->queue_cmd($vmid, $backup_cb, 'backup', %$params);
 	};
 
+	# 'getfd' and 'backup' need to use the same monitor connection, so both run while frozen
 	$qmpclient->queue_cmd($vmid, $add_fd_cb, 'getfd', fd => $outfileno, fdname => "backup");
 
 	my $fs_frozen = $self->qga_fs_freeze($task, $vmid);
@@ -713,7 +741,7 @@ sub archive_vma {
 	my $qmperr = $@;
 
 	if ($fs_frozen) {
-	    $self->qga_fs_thaw($vmid);
+	    $self->qga_fs_thaw($task, $vmid);
 	}
 
 	die $qmperr if $qmperr;
@@ -739,7 +767,7 @@ sub archive_vma {
 	$self->resume_vm_after_job_start($task, $vmid);
     }
 
-    $self->restore_vm_power_state($vmid);
+    $self->restore_vm_power_state($task, $vmid);
 
     if ($err) {
 	if ($cpid) {
@@ -777,36 +805,87 @@ sub _get_task_devlist {
 
 sub qga_fs_freeze {
     my ($self, $task, $vmid) = @_;
-    return if !$self->{vmlist}->{$vmid}->{agent} || $task->{mode} eq 'stop' || !$self->{vm_was_running} || $self->{vm_was_paused};
+    return if !$self->{vmlist}->{$vmid}->{agent} || $task->{mode} eq 'stop' || !$task->{vm_was_running} || $task->{vm_was_paused};
 
     if (!PVE::QemuServer::qga_check_running($vmid, 1)) {
 	$self->loginfo("skipping guest-agent 'fs-freeze', agent configured but not running?");
 	return;
     }
 
+    # start the watchdog first, the guest might already be frozen if the freeze command times out
+    $task->{thaw_watchdog} = $self->fork_thaw_watchdog($vmid);
+
     $self->loginfo("issuing guest-agent 'fs-freeze' command");
+    my $starttime = [gettimeofday];
     eval { mon_cmd($vmid, "guest-fsfreeze-freeze") };
     $self->logerr($@) if $@;
+    $task->{fs_frozen_since} = [gettimeofday];
+
+    my $duration = tv_interval($starttime, $task->{fs_frozen_since});
+    $self->loginfo(sprintf("guest-agent 'fs-freeze' took %.2f seconds", $duration))
+	if $duration >= 1;
 
     return 1; # even on mon command error, ensure we always thaw again
 }
 
 # only call if fs_freeze return 1
 sub qga_fs_thaw {
-    my ($self, $vmid) = @_;
+    my ($self, $task, $vmid) = @_;
 
     $self->loginfo("issuing guest-agent 'fs-thaw' command");
     eval { mon_cmd($vmid, "guest-fsfreeze-thaw") };
     $self->logerr($@) if $@;
+
+    if (my $frozen_since = delete $task->{fs_frozen_since}) {
+	my $duration = tv_interval($frozen_since);
+	$self->loginfo(sprintf("guest file systems were frozen for %.2f seconds", $duration));
+    }
+
+    if (my $watchdog = delete $task->{thaw_watchdog}) {
+	# tell the watchdog that we took care of it
+	syswrite($watchdog->{fh}, "1");
+	close($watchdog->{fh});
+	waitpid($watchdog->{pid}, 0);
+    }
+}
+
+# Forks a process that thaws the guest's file systems if this worker dies while they are frozen,
+# for example when the task gets killed. It waits for the pipe to the worker to be closed, the
+# worker writes a byte first if it thawed the guest itself.
+sub fork_thaw_watchdog {
+    my ($self, $vmid) = @_;
+
+    pipe(my $reader, my $writer) or die "unable to create pipe for thaw watchdog - $!\n";
+
+    my $pid = fork();
+    die "unable to fork thaw watchdog - $!\n" if !defined($pid);
+
+    if ($pid == 0) {
+	close($writer);
+	# the signals meant for the worker must not keep us from doing our job
+	$SIG{INT} = $SIG{TERM} = $SIG{QUIT} = $SIG{HUP} = $SIG{PIPE} = 'IGNORE';
+
+	my $buf;
+	my $count = sysread($reader, $buf, 1);
+	if (!$count) {
+	    eval { mon_cmd($vmid, "guest-fsfreeze-thaw") };
+	    warn "thaw watchdog: thawing file systems of VM $vmid failed - $@" if $@;
+	}
+	POSIX::_exit(0);
+    }
+
+    close($reader);
+
+    return { pid => $pid, fh => $writer };
 }
 
 # we need a running QEMU/KVM process for backup, starts a paused (prelaunch)
 # one if VM isn't already running
 sub enforce_vm_running_for_backup {
-    my ($self, $vmid) = @_;
+    my ($self, $task, $vmid) = @_;
 
     if (PVE::QemuServer::check_running($vmid)) {
-	$self->{vm_was_running} = 1;
+	$task->{vm_was_running} = 1;
 	return;
     }
 
@@ -827,7 +906,7 @@ sub enforce_vm_running_for_backup {
 sub resume_vm_after_job_start {
     my ($self, $task, $vmid) = @_;
 
-    return if !$self->{vm_was_running} || $self->{vm_was_paused};
+    return if !$task->{vm_was_running} || $task->{vm_was_paused};
 
     if (my $stoptime = $task->{vmstoptime}) {
 	my $delay = time() - $task->{vmstoptime};
@@ -841,10 +920,10 @@ sub resume_vm_after_job_start {
 
 # stop again if VM was not running before
 sub restore_vm_power_state {
-    my ($self, $vmid) = @_;
+    my ($self, $task, $vmid) = @_;
 
     # we always let VMs keep running
-    return if $self->{vm_was_running};
+    return if $task->{vm_was_running};
 
     eval {
 	my $resp = mon_cmd($vmid, 'query-status');
@@ -876,8 +955,8 @@ sub snapshot {
 sub cleanup {
     my ($self, $task, $vmid) = @_;
 
-    if ($self->{qmeventd_fh}) {
-	close($self->{qmeventd_fh});
+    if ($task->{qmeventd_fh}) {
+	close($task->{qmeventd_fh});
     }
 }
 
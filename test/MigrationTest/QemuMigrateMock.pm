@@ -98,6 +98,8 @@ $qemu_migrate_module->mock(
 	    return;
 	} elsif ($command eq 'block-dirty-bitmap-remove') {
 	    return;
+	} elsif ($command eq 'query-block') {
+	    return [];
 	} elsif ($command eq 'query-migrate') {
 	    return { status => 'failed' } if $fail_config->{'query-migrate'};
 	    return { status => 'completed' };
@@ -5,9 +5,11 @@ use warnings;
 
 use lib qw(..);
 
+use File::Temp;
 use Test::More;
 use Test::MockModule;
 use Socket qw(AF_INET AF_INET6);
+use Time::HiRes qw(gettimeofday tv_interval);
 
 use PVE::Tools qw(file_get_contents file_set_contents run_command);
 use PVE::INotify;
@@ -402,6 +404,93 @@ sub do_test($) {
     }
 }
 
+# benchmark mode, enabled by setting CFG2CMD_BENCH to the number of iterations per config. If
+# CFG2CMD_BENCH_MAX_MS is set too, a config whose average generation time exceeds it fails.
+my $bench_iterations = $ENV{CFG2CMD_BENCH};
+my $bench_max_ms = $ENV{CFG2CMD_BENCH_MAX_MS};
+
+# synthetic configs for worst cases not covered by the regular test configs
+sub write_bench_configs($) {
+    my ($dir) = @_;
+
+    my $base = "bootdisk: scsi0\ncores: 2\nmemory: 4096\nostype: l26\n";
+    my $configs = {};
+
+    $configs->{'bench-30-disks'} = "# TEST: 30 SCSI disks, each on its own controller\n$base"
+	. "scsihw: virtio-scsi-single\n"
+	. join('', map { "scsi$_: local:8006/vm-8006-disk-$_.qcow2,iothread=1,size=32G\n" } 0..29);
+
+    $configs->{'bench-32-nics'} = "# TEST: 32 network devices\n$base"
+	. join('', map { sprintf("net$_: virtio=A2:C0:43:77:08:%02X,bridge=vmbr0,queues=4\n", $_) } 0..31);
+
+    my @pci = grep { m/^0000:/ } @$pci_devs;
+    $configs->{'bench-hostpci'} = "# TEST: all available PCI devices passed through\n$base"
+	. "machine: q35\n"
+	. join('', map { "hostpci$_: $pci[$_],pcie=1\n" } 0..$#pci);
+
+    $configs->{'bench-numa'} = "# TEST: 8 NUMA nodes\n$base"
+	. "numa: 1\nsockets: 8\n"
+	. join('', map { "numa$_: cpus=" . ($_ * 2) . "-" . ($_ * 2 + 1) . ",memory=512\n" } 0..7);
+
+    $configs->{'bench-snapshots'} = "# TEST: 300 snapshots\n$base"
+	. "parent: snap299\nscsi0: local:8006/vm-8006-disk-0.qcow2,size=32G\n"
+	. join('', map { "\n[snap$_]\n${base}scsi0: local:8006/vm-8006-disk-0.qcow2,size=32G\n" } 0..299);
+
+    my $files = [];
+    for my $name (sort keys %$configs) {
+	my $fn = "$dir/$name.conf";
+	file_set_contents($fn, $configs->{$name});
+	push @$files, $fn;
+    }
+    return $files;
+}
+
+sub do_bench($) {
+    my ($config_fn) = @_;
+
+    parse_test $config_fn;
+
+    my $testname = $current_test->{testname};
+    return if $current_test->{expect_error};
+
+    my ($vmid, $storecfg) = $base_env->@{qw(vmid storage_config)};
+
+    my $starttime = [gettimeofday];
+    for (my $i = 0; $i < $bench_iterations; $i++) {
+	eval { PVE::QemuServer::vm_commandline($storecfg, $vmid) };
+	if (my $err = $@) {
+	    fail("$testname");
+	    note("got unexpected error: $err");
+	    return;
+	}
+    }
+    my $elapsed = tv_interval($starttime);
+
+    my $avg_ms = $elapsed * 1000 / $bench_iterations;
+    my $ops = $elapsed > 0 ? $bench_iterations / $elapsed : 0;
+    note(sprintf("%-70s %8.3f ms/op %10.1f ops/s", $testname, $avg_ms, $ops));
+
+    if (defined($bench_max_ms)) {
+	ok($avg_ms <= $bench_max_ms, "$testname - below ${bench_max_ms} ms");
+    } else {
+	pass("$testname");
+    }
+}
+
+if ($bench_iterations) {
+    die "CFG2CMD_BENCH needs to be a positive number of iterations\n"
+	if $bench_iterations !~ m/^\d+$/;
+
+    print "benchmarking config to command generation ($bench_iterations iterations each)\n";
+
+    my $tmpdir = File::Temp->newdir();
+    my @files = (<cfg2cmd/*.conf>, write_bench_configs($tmpdir)->@*);
+    do_bench $_ for @files;
+
+    done_testing();
+    exit(0);
+}
+
 print "testing config to command stabillity\n";
 
 # exec tests
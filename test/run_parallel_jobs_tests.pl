@@ -0,0 +1,88 @@
+#!/usr/bin/perl
+
+use strict;
+use warnings;
+
+use lib qw(..);
+
+use Test::More;
+use Time::HiRes qw(gettimeofday tv_interval);
+
+use PVE::QemuServer;
+
+# jobs record start and end time in the result, so that overlaps can be checked
+my $make_job = sub {
+    my ($name, $group, $duration, $fail) = @_;
+    return {
+	name => $name,
+	group => $group,
+	code => sub {
+	    my $start = [gettimeofday];
+	    select(undef, undef, undef, $duration);
+	    die "failed on purpose\n" if $fail;
+	    return { start => $start, end => [gettimeofday] };
+	},
+    };
+};
+
+my $overlap = sub {
+    my ($x, $y) = @_;
+    my ($rx, $ry) = ($x->{result}, $y->{result});
+    return tv_interval($rx->{start}, $ry->{end}) > 0 && tv_interval($ry->{start}, $rx->{end}) > 0;
+};
+
+{
+    my $jobs = [ map { $make_job->("job$_", undef, 0.2) } 1..3 ];
+    PVE::QemuServer::run_jobs_in_parallel($jobs, 3);
+    is(scalar(grep { defined($_->{result}) } @$jobs), 3, 'results are passed back');
+    ok($overlap->($jobs->[0], $jobs->[2]), 'jobs run concurrently');
+}
+
+{
+    my $jobs = [ map { $make_job->("job$_", 'store', 0.2) } 1..2 ];
+    push @$jobs, $make_job->('other', 'other-store', 0.2);
+    PVE::QemuServer::run_jobs_in_parallel($jobs, 3, { store => 1 });
+    ok(!$overlap->($jobs->[0], $jobs->[1]), 'group limit is honored');
+    ok($overlap->($jobs->[0], $jobs->[2]), 'other groups are not limited');
+}
+
+{
+    my $jobs = [ map { $make_job->("job$_", undef, 0.2) } 1..3 ];
+    PVE::QemuServer::run_jobs_in_parallel($jobs, 1);
+    ok(!$overlap->($jobs->[0], $jobs->[1]) && !$overlap->($jobs->[1], $jobs->[2]),
+	'worker limit is honored');
+}
+
+{
+    my $jobs = [
+	$make_job->('fails', undef, 0.1, 1),
+	$make_job->('slow', undef, 5),
+	$make_job->('queued', undef, 0.1),
+    ];
+    my $start = [gettimeofday];
+    eval { PVE::QemuServer::run_jobs_in_parallel($jobs, 2) };
+    like($@, qr/^fails: worker failed/, 'failure is reported');
+    ok(tv_interval($start) < 4, 'running workers are terminated on failure');
+    ok(!defined($jobs->[2]->{result}), 'no further jobs are started after a failure');
+}
+
+{
+    # larger than the pipe buffer, the worker must not block on writing it
+    my $jobs = [ { name => 'big', code => sub { return 'x' x 200_000 } } ];
+    PVE::QemuServer::run_jobs_in_parallel($jobs, 1);
+    is(length($jobs->[0]->{result} // ''), 200_000, 'large results are passed back');
+}
+
+{
+    my $other = fork() // die "fork failed - $!\n";
+    if (!$other) {
+	select(undef, undef, undef, 0.1);
+	POSIX::_exit(7);
+    }
+    my $jobs = [ $make_job->('job', undef, 0.3) ];
+    PVE::QemuServer::run_jobs_in_parallel($jobs, 1);
+    waitpid($other, 0);
+    is($? >> 8, 7, 'other children of the caller are not reaped');
+}
+
+done_testing();
@@ -60,6 +60,14 @@ my $tests = [
 	    "/var/lib/vz/images/$vmid/vm-$vmid-disk-0.qcow2", "/var/lib/vz/images/$vmid/vm-$vmid-disk-0.raw"
 	],
     },
+    {
+	name => "qcow2raw-bwlimit",
+	parameters => [ "local:$vmid/vm-$vmid-disk-0.qcow2", "local:$vmid/vm-$vmid-disk-0.raw", 1024*10, undef, 0, 2048 ],
+	expected => [
+	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-r", "2048K", "-f", "qcow2", "-O", "raw",
+	    "/var/lib/vz/images/$vmid/vm-$vmid-disk-0.qcow2", "/var/lib/vz/images/$vmid/vm-$vmid-disk-0.raw"
+	],
+    },
     {
 	name => "raw2qcow2",
 	parameters => [ "local:$vmid/vm-$vmid-disk-0.raw", "local:$vmid/vm-$vmid-disk-0.qcow2", 1024*10, undef, 0 ],
@@ -72,7 +80,7 @@ my $tests = [
 	name => "local2rbd",
 	parameters => [ "local:$vmid/vm-$vmid-disk-0.raw", "rbd-store:vm-$vmid-disk-0", 1024*10, undef, 0 ],
 	expected => [
-	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-f", "raw", "-O", "raw",
+	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-W", "-f", "raw", "-O", "raw",
 	    "/var/lib/vz/images/$vmid/vm-$vmid-disk-0.raw", "rbd:cpool/vm-$vmid-disk-0:mon_host=127.0.0.42;127.0.0.21;[\\:\\:1]:auth_supported=none"
 	]
     },
@@ -88,7 +96,7 @@ my $tests = [
 	name => "local2zos",
 	parameters => [ "local:$vmid/vm-$vmid-disk-0.raw", "zfs-over-iscsi:vm-$vmid-disk-0", 1024*10, undef, 0 ],
 	expected => [
-	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-f", "raw", "--target-image-opts",
+	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-W", "-f", "raw", "--target-image-opts",
 	    "/var/lib/vz/images/$vmid/vm-$vmid-disk-0.raw",
 	    "file.driver=iscsi,file.transport=tcp,file.initiator-name=foobar,file.portal=127.0.0.1,file.target=iqn.2019-10.org.test:foobar,file.lun=1,driver=raw"
 	]
@@ -106,7 +114,7 @@ my $tests = [
 	name => "zos2rbd",
 	parameters => [ "zfs-over-iscsi:vm-$vmid-disk-0", "rbd-store:vm-$vmid-disk-0", 1024*10, undef, 0 ],
 	expected => [
-	    "/usr/bin/qemu-img", "convert", "-p", "-n", "--image-opts", "-O", "raw",
+	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-W", "--image-opts", "-O", "raw",
 	    "file.driver=iscsi,file.transport=tcp,file.initiator-name=foobar,file.portal=127.0.0.1,file.target=iqn.2019-10.org.test:foobar,file.lun=1,driver=raw",
 	    "rbd:cpool/vm-$vmid-disk-0:mon_host=127.0.0.42;127.0.0.21;[\\:\\:1]:auth_supported=none"
 	]
@@ -115,7 +123,7 @@ my $tests = [
 	name => "rbd2zos",
 	parameters => [ "rbd-store:vm-$vmid-disk-0", "zfs-over-iscsi:vm-$vmid-disk-0", 1024*10, undef, 0  ],
 	expected => [
-	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-f", "raw", "--target-image-opts",
+	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-W", "-f", "raw", "--target-image-opts",
 	    "rbd:cpool/vm-$vmid-disk-0:mon_host=127.0.0.42;127.0.0.21;[\\:\\:1]:auth_supported=none",
 	    "file.driver=iscsi,file.transport=tcp,file.initiator-name=foobar,file.portal=127.0.0.1,file.target=iqn.2019-10.org.test:foobar,file.lun=1,driver=raw",
 	]
@@ -124,7 +132,7 @@ my $tests = [
 	name => "local2lvmthin",
 	parameters => [ "local:$vmid/vm-$vmid-disk-0.raw", "local-lvm:vm-$vmid-disk-0", 1024*10, undef, 0 ],
 	expected => [
-	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-f", "raw", "-O", "raw",
+	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-W", "-f", "raw", "-O", "raw",
 	    "/var/lib/vz/images/$vmid/vm-$vmid-disk-0.raw",
 	    "/dev/pve/vm-$vmid-disk-0",
 	]
@@ -179,7 +187,7 @@ my $tests = [
 	name => "efi2zos",
 	parameters => [ "/usr/share/kvm/OVMF_VARS-pure-efi.fd", "zfs-over-iscsi:vm-$vmid-disk-0", 1024*10, undef, 0 ],
 	expected => [
-	    "/usr/bin/qemu-img", "convert", "-p", "-n", "--target-image-opts",
+	    "/usr/bin/qemu-img", "convert", "-p", "-n", "-W", "--target-image-opts",
 	    "/usr/share/kvm/OVMF_VARS-pure-efi.fd",
 	    "file.driver=iscsi,file.transport=tcp,file.initiator-name=foobar,file.portal=127.0.0.1,file.target=iqn.2019-10.org.test:foobar,file.lun=1,driver=raw",
 	]